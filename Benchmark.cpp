@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////
+// Benchmark.cpp
+//
+// Microbenchmarks for the CPU hot paths: updateLogic(), look
+// vector, hose Bezier sampling, particles and the transparency
+// sort. Fixed seeds; each kernel is calibrated to a minimum batch
+// time, repeated, and summarized as median / MAD of ns per op.
+//
+// Usage:
+//   FireQuestBench [--reps N] [--min-ms MS] [--filter SUBSTR]
+//                  [--label TEXT] [--json PATH]
+// The JSON report (default: stdout) is meant to be diffed between
+// commits; the human-readable table goes to stderr.
+//
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Geometry.h"
+#include "Particles.h"
+#include "Simulation.h"
+#include "Transparency.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef FIREQUEST_HAVE_GITREV_H
+#include "GitRev.h"     // generated by cmake/GitRev.cmake on every build
+#else
+#define FIREQUEST_GIT_REV "unknown"
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+// Keep the compiler from discarding benchmark results.
+template <typename T>
+static void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    // volatile pointer (not pointee) so the store can't be dropped, plus a
+    // compiler barrier so value is materialized in memory before it
+    static const void* volatile sink;
+    sink = &value;
+#ifdef _MSC_VER
+    _ReadWriteBarrier();
+#endif
+#endif
+}
+
+struct BenchResult
+{
+    std::string name;
+    uint64_t iterations = 0;    // ops per repetition
+    double itemsPerOp = 1.0;    // e.g. particles or keys handled by one op
+    double median = 0, mad = 0, min = 0, mean = 0; // ns per op
+};
+
+struct Kernel
+{
+    const char* name;
+    double itemsPerOp;
+    // runs `iterations` ops; state set up once per kernel
+    std::function<void(uint64_t iterations)> run;
+};
+
+static double runBatch(const Kernel& k, uint64_t iterations)
+{
+    Clock::time_point start = Clock::now();
+    k.run(iterations);
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static BenchResult measure(const Kernel& k, int reps, double minBatchMs)
+{
+    // calibrate: double the batch until it reaches the minimum duration
+    uint64_t iterations = 1;
+    runBatch(k, iterations); // warm caches
+    while (runBatch(k, iterations) < minBatchMs * 1e6 && iterations < (1ull << 40)) iterations *= 2;
+
+    std::vector<double> samples;
+    for (int r = 0; r < reps; ++r) samples.push_back(runBatch(k, iterations) / (double)iterations);
+
+    BenchResult res;
+    res.name = k.name;
+    res.iterations = iterations;
+    res.itemsPerOp = k.itemsPerOp;
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto median = [](const std::vector<double>& v) {
+        size_t n = v.size();
+        return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+    };
+    res.median = median(sorted);
+    res.min = sorted.front();
+    double sum = 0;
+    for (double s : samples) sum += s;
+    res.mean = sum / samples.size();
+    std::vector<double> dev;
+    for (double s : samples) dev.push_back(fabs(s - res.median));
+    std::sort(dev.begin(), dev.end());
+    res.mad = median(dev);
+    return res;
+}
+
+// --- Kernels ---
+
+static std::vector<Kernel> makeKernels()
+{
+    std::vector<Kernel> kernels;
+
+    // updateLogic(): 64 stations spraying at the fire, reset when it goes out
+    kernels.push_back({ "sim_update_logic", 1.0, [](uint64_t n) {
+        static std::vector<SimState> stations;
+        if (stations.empty()) {
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> yaw(-100.0f, -80.0f), pitch(-8.0f, -3.0f);
+            stations.resize(64);
+            for (SimState& s : stations) {
+                s.pinPulled = true; s.isSpraying = true;
+                s.camYaw = yaw(rng); s.camPitch = pitch(rng); s.camZ = 15.0f;
+            }
+        }
+        for (uint64_t i = 0; i < n; ++i) {
+            SimState& s = stations[i & 63];
+            simUpdateLogic(s);
+            if (!s.fireActive) { s.fireActive = true; s.fireHealth = 100.0f; s.isSpraying = true; }
+            doNotOptimize(s);
+        }
+    } });
+
+    // look vector from yaw/pitch
+    kernels.push_back({ "sim_look_vector", 1.0, [](uint64_t n) {
+        static std::vector<SimState> cams;
+        if (cams.empty()) {
+            std::mt19937 rng(7);
+            std::uniform_real_distribution<float> yaw(-180.0f, 180.0f), pitch(-89.0f, 89.0f);
+            cams.resize(256);
+            for (SimState& s : cams) { s.camYaw = yaw(rng); s.camPitch = pitch(rng); }
+        }
+        for (uint64_t i = 0; i < n; ++i) {
+            SimState& s = cams[i & 255];
+            simComputeLook(s);
+            doNotOptimize(s.lookX);
+        }
+    } });
+
+    // CPU part of drawHoseBezierTube() with the drawApar() control points
+    kernels.push_back({ "hose_bezier_24", 23.0, [](uint64_t n) {
+        static std::vector<std::array<float, 3>> pts;
+        static std::vector<HoseSegment> segs;
+        const float r = 0.36f, h = 3.2f;
+        for (uint64_t i = 0; i < n; ++i) {
+            float wobble = (float)(i & 7) * 0.01f;
+            sampleQuadraticBezier(-r - 0.02f, h + 0.02f, 0.04f,
+                -r - 0.50f + wobble, h - 0.7f, 0.9f,
+                -r - 1.05f, h - 1.5f, 0.6f, 24, pts);
+            buildHoseSegments(pts, segs);
+            doNotOptimize(segs.data());
+        }
+    } });
+
+    // one 16 ms particle step at steady state while spraying a burning fire
+    static ParticleSystem ps;
+    static SimState sprayer;
+    particlesReset(ps, 1234u);
+    ps.maxParticles = 4096;
+    sprayer.pinPulled = true; sprayer.isSpraying = true; sprayer.camZ = 10.0f;
+    simComputeLook(sprayer);
+    for (int i = 0; i < 400; ++i) particlesUpdate(ps, sprayer, 0.016f);
+    kernels.push_back({ "particles_update_steady", (double)ps.particles.size(), [](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            particlesUpdate(ps, sprayer, 0.016f);
+            doNotOptimize(ps.particles.data());
+        }
+    } });
+
+    // transparency sort: radix vs std::stable_sort on the same random depths
+    // (both include copying the unsorted input back in)
+    static const size_t SORT_KEYS = 4096;
+    static std::vector<TranslucentPrim> sortInput;
+    {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> depth(0.1f, 60.0f);
+        sortInput.resize(SORT_KEYS);
+        for (size_t i = 0; i < SORT_KEYS; ++i) sortInput[i] = { depth(rng), 1.0f, (uint32_t)i };
+    }
+    // both must produce the same stable order, or the timings compare nothing
+    {
+        std::vector<TranslucentPrim> radix(sortInput), reference(sortInput), scratch;
+        sortBackToFront(radix, scratch);
+        std::stable_sort(reference.begin(), reference.end(),
+            [](const TranslucentPrim& a, const TranslucentPrim& b) { return a.depth > b.depth; });
+        for (size_t i = 0; i < SORT_KEYS; ++i) {
+            if (radix[i].index != reference[i].index) {
+                fprintf(stderr, "sortBackToFront disagrees with std::stable_sort at %zu\n", i);
+                exit(1);
+            }
+        }
+    }
+    kernels.push_back({ "transparency_radix_sort_4096", (double)SORT_KEYS, [](uint64_t n) {
+        static std::vector<TranslucentPrim> prims, scratch;
+        for (uint64_t i = 0; i < n; ++i) {
+            prims.assign(sortInput.begin(), sortInput.end());
+            sortBackToFront(prims, scratch);
+            doNotOptimize(prims.data());
+        }
+    } });
+    kernels.push_back({ "transparency_std_sort_4096", (double)SORT_KEYS, [](uint64_t n) {
+        static std::vector<TranslucentPrim> prims;
+        for (uint64_t i = 0; i < n; ++i) {
+            prims.assign(sortInput.begin(), sortInput.end());
+            std::stable_sort(prims.begin(), prims.end(),
+                [](const TranslucentPrim& a, const TranslucentPrim& b) { return a.depth > b.depth; });
+            doNotOptimize(prims.data());
+        }
+    } });
+
+    return kernels;
+}
+
+// --- Output ---
+
+static std::string jsonEscape(const std::string& s)
+{
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if ((unsigned char)c < 0x20) { char buf[8]; snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+        else out += c;
+    }
+    return out;
+}
+
+static const char* compilerName()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+static void writeJson(FILE* f, const std::vector<BenchResult>& results,
+    const std::string& label, int reps, double minBatchMs)
+{
+    fprintf(f, "{\n");
+    fprintf(f, "  \"suite\": \"FireQuestBench\",\n");
+    fprintf(f, "  \"git_rev\": \"%s\",\n", jsonEscape(FIREQUEST_GIT_REV).c_str());
+    fprintf(f, "  \"label\": \"%s\",\n", jsonEscape(label).c_str());
+    fprintf(f, "  \"compiler\": \"%s\",\n", jsonEscape(compilerName()).c_str());
+    fprintf(f, "  \"reps\": %d,\n", reps);
+    fprintf(f, "  \"min_batch_ms\": %g,\n", minBatchMs);
+    fprintf(f, "  \"unit\": \"ns_per_op\",\n");
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        fprintf(f, "    { \"name\": \"%s\", \"iterations\": %llu, \"items_per_op\": %g, "
+            "\"median\": %.3f, \"mad\": %.3f, \"min\": %.3f, \"mean\": %.3f }%s\n",
+            jsonEscape(r.name).c_str(), (unsigned long long)r.iterations, r.itemsPerOp,
+            r.median, r.mad, r.min, r.mean, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+static void usage(const char* argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--reps N] [--min-ms MS] [--filter SUBSTR] [--label TEXT] [--json PATH]\n", argv0);
+}
+
+int main(int argc, char** argv)
+{
+    int reps = 15;
+    double minBatchMs = 20.0;
+    std::string filter, label, jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--reps" && hasValue) reps = std::max(1, atoi(argv[++i]));
+        else if (arg == "--min-ms" && hasValue) minBatchMs = std::max(0.01, atof(argv[++i]));
+        else if (arg == "--filter" && hasValue) filter = argv[++i];
+        else if (arg == "--label" && hasValue) label = argv[++i];
+        else if (arg == "--json" && hasValue) jsonPath = argv[++i];
+        else { usage(argv[0]); return 2; }
+    }
+
+    std::vector<Kernel> kernels = makeKernels();
+    std::vector<BenchResult> results;
+    fprintf(stderr, "%-30s %12s %12s %10s %12s\n", "kernel", "median ns", "mad ns", "mad %", "ns/item");
+    for (const Kernel& k : kernels) {
+        if (!filter.empty() && strstr(k.name, filter.c_str()) == nullptr) continue;
+        BenchResult r = measure(k, reps, minBatchMs);
+        fprintf(stderr, "%-30s %12.2f %12.2f %9.1f%% %12.3f\n", r.name.c_str(), r.median, r.mad,
+            r.median > 0 ? 100.0 * r.mad / r.median : 0.0, r.median / r.itemsPerOp);
+        results.push_back(r);
+    }
+
+    FILE* out = stdout;
+    if (!jsonPath.empty()) {
+        out = fopen(jsonPath.c_str(), "w");
+        if (!out) { perror(jsonPath.c_str()); return 1; }
+    }
+    writeJson(out, results, label, reps, minBatchMs);
+    if (out != stdout) fclose(out);
+    return 0;
+}
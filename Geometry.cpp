@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////
+// Geometry.cpp
+//
+// Hose Bezier sampling and segment rotations for drawApar().
+//
+////////////////////////////////////////////////////////////////
+
+#include "Geometry.h"
+
+#include <cmath>
+
+static const float PI = 3.14159265358979323846f;
+
+void sampleQuadraticBezier(float p0x, float p0y, float p0z,
+    float p1x, float p1y, float p1z,
+    float p2x, float p2y, float p2z,
+    int segments, std::vector<std::array<float, 3>>& pts)
+{
+    pts.clear();
+    pts.reserve(segments);
+    for (int i = 0; i < segments; ++i) {
+        float t = (float)i / (segments - 1);
+        float omt = 1.0f - t;
+        float x = omt * omt * p0x + 2 * omt * t * p1x + t * t * p2x;
+        float y = omt * omt * p0y + 2 * omt * t * p1y + t * t * p2y;
+        float z = omt * omt * p0z + 2 * omt * t * p1z + t * t * p2z;
+        pts.push_back({ x,y,z });
+    }
+}
+
+void buildHoseSegments(const std::vector<std::array<float, 3>>& pts, std::vector<HoseSegment>& segs)
+{
+    segs.clear();
+    for (int i = 0; i < (int)pts.size() - 1; ++i) {
+        const auto& a = pts[i];
+        const auto& b = pts[i + 1];
+        float vx = b[0] - a[0], vy = b[1] - a[1], vz = b[2] - a[2];
+        float len = sqrtf(vx * vx + vy * vy + vz * vz);
+        if (len <= 1e-5f) continue;
+
+        // compute rotation to align +Z to vector (vx,vy,vz)
+        float ax = 0.0f, ay = 0.0f, az = 1.0f; // source axis (glu cylinder points +Z originally)
+        // rotation axis = cross(ax, v)
+        float rx = ay * vz - az * vy;
+        float ry = az * vx - ax * vz;
+        float rz = ax * vy - ay * vx;
+        float rlen = sqrtf(rx * rx + ry * ry + rz * rz);
+        float dot = ax * vx + ay * vy + az * vz;
+        float angle = 0.0f;
+        if (rlen > 1e-5f) {
+            angle = acosf(dot / (len)) * 180.0f / PI;
+            // normalize axis
+            rx /= rlen; ry /= rlen; rz /= rlen;
+        }
+        else {
+            // parallel or anti-parallel
+            rx = 1.0f; ry = 0.0f; rz = 0.0f;
+            angle = (dot >= 0.0f) ? 0.0f : 180.0f;
+        }
+
+        segs.push_back({ a[0], a[1], a[2], len, angle, rx, ry, rz });
+    }
+}
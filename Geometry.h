@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////
+// Geometry.h
+//
+// CPU geometry for the APAR model (no OpenGL): hose Bezier
+// sampling and the per-segment rotations drawHoseBezierTube()
+// hands to glRotatef.
+//
+////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+// One hose cylinder: start point, length and glRotatef(angle, axis)
+// that turns +Z onto the segment direction.
+struct HoseSegment
+{
+    float x, y, z;
+    float len;
+    float angle;        // degrees
+    float rx, ry, rz;
+};
+
+// Sample a quadratic Bezier at `segments` evenly spaced t in [0,1].
+void sampleQuadraticBezier(float p0x, float p0y, float p0z,
+    float p1x, float p1y, float p1z,
+    float p2x, float p2y, float p2z,
+    int segments, std::vector<std::array<float, 3>>& pts);
+
+// Build cylinders between consecutive samples; degenerate segments are skipped.
+void buildHoseSegments(const std::vector<std::array<float, 3>>& pts, std::vector<HoseSegment>& segs);
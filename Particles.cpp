@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////
+// Particles.cpp
+//
+// Emission and integration for the flame, smoke and spray
+// particles drawn by the transparency pass.
+//
+////////////////////////////////////////////////////////////////
+
+#include "Particles.h"
+
+#include <cmath>
+
+// emission rates in particles per second at full fire / full spray
+static const float FLAME_RATE = 120.0f;
+static const float SMOKE_RATE = 30.0f;
+static const float STEAM_RATE = 40.0f; // extra smoke while the fire is being hit
+static const float SPRAY_RATE = 240.0f;
+static const float GRAVITY = -9.8f;
+
+static float frand(ParticleSystem& ps)
+{
+    // xorshift32
+    uint32_t x = ps.rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    ps.rng = x;
+    return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+static float frange(ParticleSystem& ps, float lo, float hi) { return lo + (hi - lo) * frand(ps); }
+
+static int takeEmitCount(ParticleSystem& ps, ParticleKind kind, float rate, float dt)
+{
+    float& debt = ps.emitDebt[kind];
+    debt += rate * dt;
+    int n = (int)debt;
+    debt -= (float)n;
+    return n;
+}
+
+static void spawn(ParticleSystem& ps, const Particle& p)
+{
+    if (ps.particles.size() < ps.maxParticles) ps.particles.push_back(p);
+}
+
+void particlesReset(ParticleSystem& ps, uint32_t seed)
+{
+    ps.particles.clear();
+    ps.rng = seed ? seed : 1u;
+    ps.emitDebt[0] = ps.emitDebt[1] = ps.emitDebt[2] = 0.0f;
+}
+
+void particlesUpdate(ParticleSystem& ps, const SimState& s, float dt)
+{
+    // age and integrate, compacting dead particles in place
+    size_t alive = 0;
+    for (size_t i = 0; i < ps.particles.size(); ++i) {
+        Particle p = ps.particles[i];
+        p.age += dt;
+        if (p.age >= p.life) continue;
+        if (p.kind == PARTICLE_SPRAY) p.vy += GRAVITY * dt;
+        p.x += p.vx * dt; p.y += p.vy * dt; p.z += p.vz * dt;
+        if (p.y < 0.0f) { p.y = 0.0f; p.vy = 0.0f; } // floor
+        ps.particles[alive++] = p;
+    }
+    ps.particles.resize(alive);
+
+    if (s.fireActive) {
+        float strength = s.fireHealth / 100.0f;
+        int n = takeEmitCount(ps, PARTICLE_FLAME, FLAME_RATE * strength, dt);
+        for (int i = 0; i < n; ++i) {
+            float r = frange(ps, 0.0f, 1.2f) * strength;
+            float a = frange(ps, 0.0f, 6.2831853f);
+            Particle p;
+            p.x = s.fireX + r * cosf(a); p.y = frange(ps, 0.2f, 1.5f); p.z = s.fireZ + r * sinf(a);
+            p.vx = frange(ps, -0.3f, 0.3f); p.vy = frange(ps, 2.0f, 3.5f); p.vz = frange(ps, -0.3f, 0.3f);
+            p.age = 0.0f; p.life = frange(ps, 0.5f, 1.0f);
+            p.size0 = frange(ps, 0.5f, 0.8f); p.size1 = 0.1f;
+            p.kind = PARTICLE_FLAME;
+            spawn(ps, p);
+        }
+
+        float smokeRate = SMOKE_RATE * strength + (s.isSpraying ? STEAM_RATE : 0.0f);
+        n = takeEmitCount(ps, PARTICLE_SMOKE, smokeRate, dt);
+        for (int i = 0; i < n; ++i) {
+            Particle p;
+            p.x = s.fireX + frange(ps, -0.6f, 0.6f); p.y = s.fireY + 3.0f; p.z = s.fireZ + frange(ps, -0.6f, 0.6f);
+            p.vx = frange(ps, -0.4f, 0.4f); p.vy = frange(ps, 0.8f, 1.4f); p.vz = frange(ps, -0.4f, 0.4f);
+            p.age = 0.0f; p.life = frange(ps, 3.0f, 4.0f);
+            p.size0 = 0.6f; p.size1 = frange(ps, 1.8f, 2.6f);
+            p.kind = PARTICLE_SMOKE;
+            spawn(ps, p);
+        }
+    }
+
+    if (s.isSpraying) {
+        // same origin as the spray cone in main.cpp: just below and in front of the camera
+        float ox = s.camX + s.lookX * 1.5f, oy = s.camY + s.lookY * 1.5f - 0.5f, oz = s.camZ + s.lookZ * 1.5f;
+        int n = takeEmitCount(ps, PARTICLE_SPRAY, SPRAY_RATE, dt);
+        for (int i = 0; i < n; ++i) {
+            float speed = frange(ps, 10.0f, 14.0f);
+            Particle p;
+            p.x = ox; p.y = oy; p.z = oz;
+            p.vx = s.lookX * speed + frange(ps, -1.5f, 1.5f);
+            p.vy = s.lookY * speed + frange(ps, -1.0f, 1.5f);
+            p.vz = s.lookZ * speed + frange(ps, -1.5f, 1.5f);
+            p.age = 0.0f; p.life = frange(ps, 0.6f, 1.0f);
+            p.size0 = 0.08f; p.size1 = frange(ps, 0.35f, 0.55f);
+            p.kind = PARTICLE_SPRAY;
+            spawn(ps, p);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////
+// Particles.h
+//
+// Flame, smoke and spray particles (no OpenGL). Emission follows
+// the SimState: flames/smoke while the fire burns, droplets while
+// spraying. Seeded RNG so runs are reproducible.
+//
+////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Simulation.h"
+
+enum ParticleKind : uint8_t
+{
+    PARTICLE_FLAME = 0,
+    PARTICLE_SMOKE,
+    PARTICLE_SPRAY
+};
+
+struct Particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float age, life;    // seconds
+    float size0, size1; // radius at birth / death
+    ParticleKind kind;
+
+    float t() const { return age / life; }
+    float size() const { return size0 + (size1 - size0) * t(); }
+};
+
+struct ParticleSystem
+{
+    std::vector<Particle> particles;
+    size_t maxParticles = 1024;
+    uint32_t rng = 0x9E3779B9u;
+    float emitDebt[3] = { 0.0f, 0.0f, 0.0f }; // fractional particles carried between steps
+};
+
+void particlesReset(ParticleSystem& ps, uint32_t seed = 0x9E3779B9u);
+
+// Emit for this step and integrate all particles by dt seconds.
+void particlesUpdate(ParticleSystem& ps, const SimState& s, float dt);
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////
+// Simulation.cpp
+//
+// updateLogic() state machine and input handling, split out of
+// main.cpp so it can run headless (training server, benchmarks).
+//
+////////////////////////////////////////////////////////////////
+
+#include "Simulation.h"
+
+#include <cmath>
+
+static const float PI = 3.14159265358979323846f;
+static float toRadians(float degrees) { return degrees * PI / 180.0f; }
+
+const char* simMessageText(SimMessage msg)
+{
+    switch (msg)
+    {
+    case MSG_LOCKED: return "APAR Terkunci. Tekan 'E' untuk Tarik Pin.";
+    case MSG_READY: return "APAR Siap. Tahan Klik Kiri untuk Semprot (SQUEEZE).";
+    case MSG_SPRAYING: return "Menyemprot! Arahkan ke DASAR Api (AIM & SWEEP)!";
+    case MSG_EXTINGUISHED: return "Api Berhasil Dipadamkan! Tekan 'R' untuk Reset.";
+    default: return "";
+    }
+}
+
+void simReset(SimState& s)
+{
+    s.pinPulled = false;
+    s.isSpraying = false;
+    s.fireActive = true;
+    s.fireHealth = 100.0f;
+    s.camX = 0.0f; s.camY = 5.0f; s.camZ = 20.0f;
+    s.camYaw = 0.0f; s.camPitch = 0.0f;
+}
+
+void simComputeLook(SimState& s)
+{
+    s.lookX = cosf(toRadians(s.camYaw)) * cosf(toRadians(s.camPitch));
+    s.lookY = sinf(toRadians(s.camPitch));
+    s.lookZ = sinf(toRadians(s.camYaw)) * cosf(toRadians(s.camPitch));
+    float len = sqrtf(s.lookX * s.lookX + s.lookY * s.lookY + s.lookZ * s.lookZ);
+    if (len > 1e-6f) { s.lookX /= len; s.lookY /= len; s.lookZ /= len; }
+}
+
+void simUpdateLogic(SimState& s)
+{
+    simComputeLook(s);
+
+    if (!s.fireActive) {
+        s.message = MSG_EXTINGUISHED;
+        s.isSpraying = false;
+    }
+    else if (!s.pinPulled) {
+        s.message = MSG_LOCKED;
+    }
+    else if (!s.isSpraying) {
+        s.message = MSG_READY;
+    }
+    else {
+        s.message = MSG_SPRAYING;
+    }
+
+    if (s.isSpraying && s.fireActive) {
+        float vx = s.fireX - s.camX, vy = s.fireY - s.camY, vz = s.fireZ - s.camZ;
+        float dist = sqrtf(vx * vx + vy * vy + vz * vz);
+        if (dist > 1e-6f) { vx /= dist; vy /= dist; vz /= dist; }
+        float dot = s.lookX * vx + s.lookY * vy + s.lookZ * vz;
+        if (dot > 0.95f && dist < 25.0f) s.fireHealth -= 1.5f;
+    }
+
+    if (s.fireHealth <= 0.0f) s.fireActive = false;
+}
+
+bool simKeyInput(SimState& s, unsigned char key)
+{
+    float rightX = cosf(toRadians(s.camYaw - 90.0f));
+    float rightZ = sinf(toRadians(s.camYaw - 90.0f));
+
+    switch (key)
+    {
+    case 'w': s.camX += s.lookX * SIM_MOVE_SPEED; s.camZ += s.lookZ * SIM_MOVE_SPEED; break;
+    case 's': s.camX -= s.lookX * SIM_MOVE_SPEED; s.camZ -= s.lookZ * SIM_MOVE_SPEED; break;
+    case 'a': s.camX += rightX * SIM_MOVE_SPEED; s.camZ += rightZ * SIM_MOVE_SPEED; break;
+    case 'd': s.camX -= rightX * SIM_MOVE_SPEED; s.camZ -= rightZ * SIM_MOVE_SPEED; break;
+    case 'e': if (!s.pinPulled) s.pinPulled = true; break;
+    case 'r': simReset(s); break;
+    default: return false;
+    }
+    return true;
+}
+
+void simMouseButton(SimState& s, bool down)
+{
+    if (down) {
+        if (s.pinPulled && s.fireActive) s.isSpraying = true;
+    }
+    else {
+        s.isSpraying = false;
+    }
+}
+
+void simMouseLook(SimState& s, float deltaX, float deltaY)
+{
+    s.camYaw += deltaX * SIM_MOUSE_SENSITIVITY;
+    s.camPitch -= deltaY * SIM_MOUSE_SENSITIVITY;
+    if (s.camPitch > 89.0f) s.camPitch = 89.0f;
+    if (s.camPitch < -89.0f) s.camPitch = -89.0f;
+}
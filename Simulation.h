@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////
+// Simulation.h
+//
+// Simulation state and logic (no OpenGL). Shared by the GLUT
+// client in main.cpp and the multi-session training server.
+//
+////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+// Status line shown to the trainee; index into simMessageText().
+enum SimMessage : uint8_t
+{
+    MSG_LOCKED = 0,     // pin still in place
+    MSG_READY,          // pin pulled, not spraying
+    MSG_SPRAYING,       // squeezing the lever
+    MSG_EXTINGUISHED,   // fire is out
+    MSG_COUNT
+};
+
+// Complete state of one trainee station.
+struct SimState
+{
+    float camX = 0.0f;
+    float camY = 5.0f;
+    float camZ = 20.0f;
+    float camYaw = 0.0f;
+    float camPitch = 0.0f;
+
+    float lookX = 0.0f;
+    float lookY = 0.0f;
+    float lookZ = -1.0f;
+
+    bool pinPulled = false;
+    bool isSpraying = false;
+
+    bool fireActive = true;
+    float fireHealth = 100.0f;
+    float fireX = 0.0f, fireY = 2.5f, fireZ = -5.0f;
+
+    SimMessage message = MSG_LOCKED;
+};
+
+static const float SIM_MOVE_SPEED = 0.5f;
+static const float SIM_MOUSE_SENSITIVITY = 0.15f;
+
+const char* simMessageText(SimMessage msg);
+
+// Restore the initial scenario (camera, pin, fire).
+void simReset(SimState& s);
+
+// Unit look vector from camYaw/camPitch.
+void simComputeLook(SimState& s);
+
+// Advance one fixed tick: look vector, status message, fire damage.
+void simUpdateLogic(SimState& s);
+
+// Input handlers, mirroring the GLUT callbacks.
+// simKeyInput returns false for keys the simulation does not consume (e.g. ESC).
+bool simKeyInput(SimState& s, unsigned char key);
+void simMouseButton(SimState& s, bool down);
+void simMouseLook(SimState& s, float deltaX, float deltaY);
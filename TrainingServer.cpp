@@ -0,0 +1,678 @@
+////////////////////////////////////////////////////////////////
+// TrainingServer.cpp
+//
+// Headless multi-session server for the training center: hosts one
+// SimState per trainee station, steps every session at its own fixed
+// tick on a shared thread pool, and talks to thin clients over a local
+// Unix socket (input events in, compact state deltas out).
+//
+// POSIX only (AF_UNIX + SOCK_SEQPACKET): the FireQuestServer target in
+// CMakeLists.txt, not part of FireQuest.vcxproj.
+//
+// Usage:
+//   FireQuestServer [--socket PATH] [--threads N] [--report SEC]
+//                   [--demo-clients N] [--demo-seconds SEC]
+// --demo-clients starts N local stand-in clients and exits after
+// --demo-seconds with a final latency report.
+//
+////////////////////////////////////////////////////////////////
+
+#include "Simulation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+// --- Wire protocol ---
+// One message per SOCK_SEQPACKET packet, host byte order (local socket only).
+
+// Client -> server, fixed 8 bytes.
+enum InputType : uint8_t
+{
+    IN_HELLO = 1,       // tickMs = requested tick period
+    IN_KEY,             // key = ASCII key as in keyInput()
+    IN_MOUSE_DOWN,
+    IN_MOUSE_UP,
+    IN_LOOK,            // dx/dy = mouse delta in pixels, as in passiveMotion()
+    IN_BYE
+};
+
+struct InputPacket
+{
+    uint8_t type;
+    uint8_t key;
+    uint16_t tickMs;
+    int16_t dx;
+    int16_t dy;
+};
+static_assert(sizeof(InputPacket) == 8, "InputPacket must stay 8 bytes");
+
+// Server -> client: uint32 tick, uint8 mask, then only the field groups
+// whose bit is set, in bit order. Nothing is sent for unchanged ticks.
+enum DeltaBits : uint8_t
+{
+    D_CAM_POS = 1 << 0,     // float camX, camY, camZ
+    D_CAM_ANGLES = 1 << 1,  // float camYaw, camPitch
+    D_FLAGS = 1 << 2,       // uint8 pinPulled | isSpraying << 1 | fireActive << 2
+    D_FIRE_HEALTH = 1 << 3, // float fireHealth
+    D_MESSAGE = 1 << 4,     // uint8 SimMessage
+    D_ALL = 0x1F
+};
+
+static const size_t DELTA_MAX_BYTES = 4 + 1 + 12 + 8 + 1 + 4 + 1;
+
+static uint8_t packFlags(const SimState& s)
+{
+    return (uint8_t)((s.pinPulled ? 1 : 0) | (s.isSpraying ? 2 : 0) | (s.fireActive ? 4 : 0));
+}
+
+static uint8_t diffMask(const SimState& a, const SimState& b)
+{
+    uint8_t mask = 0;
+    if (a.camX != b.camX || a.camY != b.camY || a.camZ != b.camZ) mask |= D_CAM_POS;
+    if (a.camYaw != b.camYaw || a.camPitch != b.camPitch) mask |= D_CAM_ANGLES;
+    if (packFlags(a) != packFlags(b)) mask |= D_FLAGS;
+    if (a.fireHealth != b.fireHealth) mask |= D_FIRE_HEALTH;
+    if (a.message != b.message) mask |= D_MESSAGE;
+    return mask;
+}
+
+template <typename T>
+static void put(uint8_t*& p, T v) { memcpy(p, &v, sizeof(T)); p += sizeof(T); }
+
+template <typename T>
+static bool get(const uint8_t*& p, const uint8_t* end, T& v)
+{
+    if (end - p < (ptrdiff_t)sizeof(T)) return false;
+    memcpy(&v, p, sizeof(T)); p += sizeof(T);
+    return true;
+}
+
+static size_t encodeDelta(uint8_t* buf, uint32_t tick, uint8_t mask, const SimState& s)
+{
+    uint8_t* p = buf;
+    put(p, tick);
+    put(p, mask);
+    if (mask & D_CAM_POS) { put(p, s.camX); put(p, s.camY); put(p, s.camZ); }
+    if (mask & D_CAM_ANGLES) { put(p, s.camYaw); put(p, s.camPitch); }
+    if (mask & D_FLAGS) put(p, packFlags(s));
+    if (mask & D_FIRE_HEALTH) put(p, s.fireHealth);
+    if (mask & D_MESSAGE) put(p, (uint8_t)s.message);
+    return (size_t)(p - buf);
+}
+
+static bool decodeDelta(const uint8_t* buf, size_t len, uint32_t& tick, SimState& s)
+{
+    const uint8_t* p = buf;
+    const uint8_t* end = buf + len;
+    uint8_t mask = 0;
+    if (!get(p, end, tick) || !get(p, end, mask)) return false;
+    if (mask & D_CAM_POS) {
+        if (!get(p, end, s.camX) || !get(p, end, s.camY) || !get(p, end, s.camZ)) return false;
+    }
+    if (mask & D_CAM_ANGLES) {
+        if (!get(p, end, s.camYaw) || !get(p, end, s.camPitch)) return false;
+    }
+    if (mask & D_FLAGS) {
+        uint8_t f = 0;
+        if (!get(p, end, f)) return false;
+        s.pinPulled = (f & 1) != 0; s.isSpraying = (f & 2) != 0; s.fireActive = (f & 4) != 0;
+    }
+    if (mask & D_FIRE_HEALTH) {
+        if (!get(p, end, s.fireHealth)) return false;
+    }
+    if (mask & D_MESSAGE) {
+        uint8_t m = 0;
+        if (!get(p, end, m) || m >= MSG_COUNT) return false;
+        s.message = (SimMessage)m;
+    }
+    return p == end;
+}
+
+// --- Sessions ---
+
+static const int DEFAULT_TICK_MS = 16; // same as glutTimerFunc(16, ...) in main.cpp
+
+// Per-session tick timings collected between two reports.
+struct TickStats
+{
+    std::vector<float> latenessUs; // tick start minus scheduled due time
+    double stepUsTotal = 0.0;
+    uint64_t ticks = 0;
+    uint64_t skipped = 0;          // ticks dropped to catch up after falling behind
+    uint64_t bytesSent = 0;
+};
+
+struct Session
+{
+    int id = 0;
+    int fd = -1;
+    std::atomic<int> tickUs{ DEFAULT_TICK_MS * 1000 };
+    std::atomic<bool> closed{ false };
+
+    std::mutex inputMutex;
+    std::vector<InputPacket> pending;
+
+    // only touched by the worker currently stepping this session
+    SimState state;
+    SimState sent;          // last state the client is known to have
+    bool sentValid = false;
+    uint32_t tick = 0;
+
+    std::mutex statsMutex;
+    TickStats stats;
+    uint64_t totalTicks = 0;
+
+    ~Session() { if (fd >= 0) close(fd); }
+};
+
+// Min-heap of (due time, session id) shared by the worker pool.
+// A session is in the heap at most once, so only one worker steps it at a time.
+class TickScheduler
+{
+public:
+    void schedule(int id, Clock::time_point due)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            heap.push({ due, id });
+        }
+        cv.notify_one();
+    }
+
+    // Blocks until the earliest session is due; false once stopped.
+    bool next(int& id, Clock::time_point& due)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            if (stopping) return false;
+            if (heap.empty()) { cv.wait(lock); continue; }
+            Entry top = heap.top();
+            if (top.due > Clock::now()) { cv.wait_until(lock, top.due); continue; }
+            heap.pop();
+            id = top.id; due = top.due;
+            return true;
+        }
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+    }
+
+private:
+    struct Entry
+    {
+        Clock::time_point due;
+        int id;
+        bool operator>(const Entry& o) const { return due > o.due; }
+    };
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopping = false;
+};
+
+class TrainingServer
+{
+public:
+    TrainingServer(const std::string& path, int threads) : socketPath(path), threadCount(threads) {}
+    ~TrainingServer() { stop(); }
+
+    bool start()
+    {
+        listenFd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+        if (listenFd < 0) { perror("socket"); return false; }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(addr.sun_path)) {
+            fprintf(stderr, "socket path too long: %s\n", socketPath.c_str());
+            return failStart();
+        }
+        strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+        if (!removeStaleSocket(addr)) return failStart();
+        if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0) { perror("bind"); return failStart(); }
+        if (listen(listenFd, 64) < 0) { perror("listen"); return failStart(); }
+
+        running = true;
+        ioThread = std::thread(&TrainingServer::ioLoop, this);
+        for (int i = 0; i < threadCount; ++i)
+            workers.emplace_back(&TrainingServer::workerLoop, this);
+        printf("FireQuest server: %s, %d worker threads\n", socketPath.c_str(), threadCount);
+        return true;
+    }
+
+    void stop()
+    {
+        if (!running.exchange(false)) return;
+        scheduler.stop();
+        for (auto& w : workers) w.join();
+        workers.clear();
+        if (ioThread.joinable()) ioThread.join();
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex);
+            sessions.clear();
+        }
+        if (listenFd >= 0) { close(listenFd); listenFd = -1; }
+        unlink(socketPath.c_str());
+    }
+
+    // Print tick latency per session since the previous report.
+    void report(double windowSec)
+    {
+        std::vector<std::shared_ptr<Session>> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex);
+            for (auto& kv : sessions) snapshot.push_back(kv.second);
+        }
+        printf("\n%-8s %6s %8s %8s %10s %10s %10s %9s %8s\n",
+            "session", "tickms", "ticks", "hz", "late p50", "late p99", "late max", "step avg", "skipped");
+        std::vector<float> all;
+        uint64_t allTicks = 0, allBytes = 0;
+        for (auto& s : snapshot) {
+            TickStats st;
+            uint64_t total;
+            {
+                std::lock_guard<std::mutex> lock(s->statsMutex);
+                std::swap(st, s->stats);
+                total = s->totalTicks;
+            }
+            allTicks += st.ticks;
+            allBytes += st.bytesSent;
+            all.insert(all.end(), st.latenessUs.begin(), st.latenessUs.end());
+            printf("%-8d %6.1f %8llu %8.1f %8.0fus %8.0fus %8.0fus %7.1fus %8llu\n",
+                s->id, s->tickUs.load() / 1000.0, (unsigned long long)total,
+                st.ticks / windowSec, percentile(st.latenessUs, 0.50f),
+                percentile(st.latenessUs, 0.99f), percentile(st.latenessUs, 1.0f),
+                st.ticks ? st.stepUsTotal / st.ticks : 0.0, (unsigned long long)st.skipped);
+        }
+        printf("%zu sessions, %.0f ticks/s, %.1f KiB/s out, lateness p50 %.0fus p99 %.0fus\n",
+            snapshot.size(), allTicks / windowSec, allBytes / windowSec / 1024.0,
+            percentile(all, 0.50f), percentile(all, 0.99f));
+        fflush(stdout);
+    }
+
+private:
+    bool failStart()
+    {
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    // Only ever unlink a socket left behind by a dead server: refuse other
+    // file types and sockets that still accept connections.
+    bool removeStaleSocket(const sockaddr_un& addr)
+    {
+        struct stat st;
+        if (lstat(socketPath.c_str(), &st) < 0) {
+            if (errno == ENOENT) return true;
+            perror(socketPath.c_str());
+            return false;
+        }
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "%s exists and is not a socket\n", socketPath.c_str());
+            return false;
+        }
+        int probe = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+        if (probe < 0) { perror("socket"); return false; }
+        int rc = connect(probe, (const sockaddr*)&addr, sizeof(addr));
+        int err = errno;
+        close(probe);
+        if (rc == 0) {
+            fprintf(stderr, "%s already in use by another server\n", socketPath.c_str());
+            return false;
+        }
+        // only ECONNREFUSED proves nobody is listening; anything else (e.g.
+        // EPROTOTYPE from a live SOCK_STREAM listener) means leave it alone
+        if (err != ECONNREFUSED) {
+            fprintf(stderr, "%s: cannot tell whether the socket is stale: %s\n",
+                socketPath.c_str(), strerror(err));
+            return false;
+        }
+        unlink(socketPath.c_str());
+        return true;
+    }
+
+    static float percentile(std::vector<float>& v, float q)
+    {
+        if (v.empty()) return 0.0f;
+        size_t k = std::min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5f));
+        std::nth_element(v.begin(), v.begin() + k, v.end());
+        return v[k];
+    }
+
+    std::shared_ptr<Session> findSession(int id)
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        auto it = sessions.find(id);
+        return it == sessions.end() ? nullptr : it->second;
+    }
+
+    void acceptClient()
+    {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) return;
+        auto s = std::make_shared<Session>();
+        s->fd = fd;
+        simReset(s->state);
+        simUpdateLogic(s->state);
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex);
+            s->id = nextSessionId++;
+            sessions[s->id] = s;
+        }
+        scheduler.schedule(s->id, Clock::now() + std::chrono::microseconds(s->tickUs.load()));
+    }
+
+    void dropSession(int id)
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        auto it = sessions.find(id);
+        if (it == sessions.end()) return;
+        it->second->closed = true;
+        sessions.erase(it); // fd closes when the last worker reference goes away
+    }
+
+    // Reads input events into each session's queue; they are applied on the next tick.
+    void ioLoop()
+    {
+        std::vector<pollfd> fds;
+        std::vector<std::shared_ptr<Session>> polled;
+        while (running) {
+            fds.clear();
+            polled.clear();
+            fds.push_back({ listenFd, POLLIN, 0 });
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex);
+                for (auto& kv : sessions) {
+                    fds.push_back({ kv.second->fd, POLLIN, 0 });
+                    polled.push_back(kv.second);
+                }
+            }
+            if (poll(fds.data(), fds.size(), 100) <= 0) continue;
+
+            if (fds[0].revents & POLLIN) acceptClient();
+            for (size_t i = 1; i < fds.size(); ++i) {
+                if (!fds[i].revents) continue;
+                Session& s = *polled[i - 1];
+                InputPacket pkt;
+                ssize_t n = recv(s.fd, &pkt, sizeof(pkt), MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR) ||
+                    (fds[i].revents & (POLLHUP | POLLERR))) {
+                    dropSession(s.id);
+                    continue;
+                }
+                if (n != (ssize_t)sizeof(pkt)) continue;
+                if (pkt.type == IN_HELLO) {
+                    int ms = std::max(1, std::min(1000, (int)pkt.tickMs));
+                    s.tickUs = ms * 1000;
+                }
+                else if (pkt.type == IN_BYE) {
+                    dropSession(s.id);
+                }
+                else {
+                    std::lock_guard<std::mutex> lock(s.inputMutex);
+                    s.pending.push_back(pkt);
+                }
+            }
+        }
+    }
+
+    void workerLoop()
+    {
+        std::vector<InputPacket> inputs;
+        int id;
+        Clock::time_point due;
+        while (scheduler.next(id, due)) {
+            std::shared_ptr<Session> s = findSession(id);
+            if (!s || s->closed) continue;
+
+            Clock::time_point start = Clock::now();
+            inputs.clear();
+            {
+                std::lock_guard<std::mutex> lock(s->inputMutex);
+                inputs.swap(s->pending);
+            }
+            size_t sent = step(*s, inputs);
+            Clock::time_point end = Clock::now();
+
+            // fixed tick: next due is one period after this one, unless we fell
+            // more than a period behind, in which case the missed ticks are dropped
+            std::chrono::microseconds period(s->tickUs.load());
+            Clock::time_point nextDue = due + period;
+            uint64_t skipped = 0;
+            if (nextDue + period < end) {
+                skipped = (uint64_t)((end - nextDue) / period);
+                nextDue += period * (long long)skipped;
+            }
+            {
+                std::lock_guard<std::mutex> lock(s->statsMutex);
+                s->stats.latenessUs.push_back(
+                    std::chrono::duration<float, std::micro>(start - due).count());
+                s->stats.stepUsTotal += std::chrono::duration<double, std::micro>(end - start).count();
+                s->stats.ticks++;
+                s->stats.skipped += skipped;
+                s->stats.bytesSent += sent;
+                s->totalTicks++;
+            }
+            scheduler.schedule(id, nextDue);
+        }
+    }
+
+    // One fixed tick of one session: inputs, updateLogic, delta out.
+    static size_t step(Session& s, const std::vector<InputPacket>& inputs)
+    {
+        for (const InputPacket& in : inputs) {
+            switch (in.type)
+            {
+            case IN_KEY: simKeyInput(s.state, in.key); break;
+            case IN_MOUSE_DOWN: simMouseButton(s.state, true); break;
+            case IN_MOUSE_UP: simMouseButton(s.state, false); break;
+            case IN_LOOK: simMouseLook(s.state, (float)in.dx, (float)in.dy); break;
+            }
+        }
+        simUpdateLogic(s.state);
+        s.tick++;
+
+        uint8_t mask = s.sentValid ? diffMask(s.sent, s.state) : (uint8_t)D_ALL;
+        if (!mask) return 0;
+        uint8_t buf[DELTA_MAX_BYTES];
+        size_t len = encodeDelta(buf, s.tick, mask, s.state);
+        // never block a pool thread on a slow client: if the send buffer is full
+        // the baseline stays put and the next tick sends a larger delta instead
+        ssize_t n = send(s.fd, buf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n != (ssize_t)len) return 0;
+        s.sent = s.state;
+        s.sentValid = true;
+        return len;
+    }
+
+    std::string socketPath;
+    int threadCount;
+    int listenFd = -1;
+    std::atomic<bool> running{ false };
+
+    TickScheduler scheduler;
+    std::thread ioThread;
+    std::vector<std::thread> workers;
+
+    std::mutex sessionsMutex;
+    std::map<int, std::shared_ptr<Session>> sessions;
+    int nextSessionId = 1;
+};
+
+// --- Local stand-in client ---
+// Plays one trainee: pull pin, turn to the fire, walk in, squeeze and sweep.
+// Keeps a mirror of the station state purely from the received deltas.
+struct DemoClientResult
+{
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    bool extinguished = false;
+    bool protocolError = false;
+};
+
+static void runDemoClient(const std::string& path, int index, int tickMs,
+    std::atomic<bool>& stopFlag, DemoClientResult& result)
+{
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0) { result.protocolError = true; return; }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        result.protocolError = true;
+        return;
+    }
+
+    auto sendInput = [fd](uint8_t type, uint8_t key = 0, int dx = 0, int dy = 0, int ms = 0) {
+        InputPacket pkt{ type, key, (uint16_t)ms, (int16_t)dx, (int16_t)dy };
+        send(fd, &pkt, sizeof(pkt), MSG_NOSIGNAL);
+    };
+
+    // script: yaw -90 (dx -600), pitch ~ -5.7 (dy +38), then step closer
+    std::vector<InputPacket> script;
+    script.push_back({ IN_KEY, 'e', 0, 0, 0 });
+    for (int i = 0; i < 6; ++i) script.push_back({ IN_LOOK, 0, 0, -100, 0 });
+    script.push_back({ IN_LOOK, 0, 0, 0, 38 });
+    for (int i = 0; i < 4; ++i) script.push_back({ IN_KEY, 'w', 0, 0, 0 });
+    script.push_back({ IN_MOUSE_DOWN, 0, 0, 0, 0 });
+
+    std::mt19937 rng(1234u + (unsigned)index);
+    std::uniform_int_distribution<int> jitter(-2, 2);
+
+    sendInput(IN_HELLO, 0, 0, 0, tickMs);
+    SimState mirror;
+    size_t next = 0;
+    uint8_t buf[256];
+    while (!stopFlag) {
+        if (next < script.size()) {
+            const InputPacket& p = script[next++];
+            sendInput(p.type, p.key, p.dx, p.dy);
+        }
+        else if (mirror.fireActive) {
+            sendInput(IN_LOOK, 0, jitter(rng), 0); // small sweep around the base
+        }
+
+        pollfd pfd{ fd, POLLIN, 0 };
+        if (poll(&pfd, 1, tickMs) <= 0) continue;
+        for (;;) {
+            ssize_t n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+            if (n <= 0) break;
+            uint32_t tick;
+            if (!decodeDelta(buf, (size_t)n, tick, mirror)) result.protocolError = true;
+            result.packets++;
+            result.bytes += (uint64_t)n;
+        }
+    }
+    result.extinguished = !mirror.fireActive;
+    sendInput(IN_BYE);
+    close(fd);
+}
+
+// --- Main ---
+static volatile sig_atomic_t gInterrupted = 0;
+static void onSignal(int) { gInterrupted = 1; }
+
+static void usage(const char* argv0)
+{
+    fprintf(stderr,
+        "usage: %s [--socket PATH] [--threads N] [--report SEC]\n"
+        "          [--demo-clients N] [--demo-seconds SEC]\n", argv0);
+}
+
+int main(int argc, char** argv)
+{
+    std::string socketPath = "/tmp/firequest.sock";
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    double reportSec = 5.0;
+    int demoClients = 0;
+    double demoSeconds = 10.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue) socketPath = argv[++i];
+        else if (arg == "--threads" && hasValue) threads = std::max(1, atoi(argv[++i]));
+        else if (arg == "--report" && hasValue) reportSec = std::max(0.1, atof(argv[++i]));
+        else if (arg == "--demo-clients" && hasValue) demoClients = std::max(0, atoi(argv[++i]));
+        else if (arg == "--demo-seconds" && hasValue) demoSeconds = std::max(0.1, atof(argv[++i]));
+        else { usage(argv[0]); return 2; }
+    }
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    TrainingServer server(socketPath, threads);
+    if (!server.start()) return 1;
+
+    std::atomic<bool> clientsStop{ false };
+    std::vector<std::thread> clients;
+    std::vector<DemoClientResult> results(demoClients);
+    static const int demoTickMs[] = { 16, 16, 20, 33 }; // stations at different rates
+    for (int i = 0; i < demoClients; ++i) {
+        clients.emplace_back(runDemoClient, socketPath, i, demoTickMs[i % 4],
+            std::ref(clientsStop), std::ref(results[i]));
+    }
+
+    Clock::time_point started = Clock::now();
+    Clock::time_point lastReport = started;
+    while (!gInterrupted) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        Clock::time_point now = Clock::now();
+        // demo deadline first, so the final report below gets this window's stats
+        if (demoClients && std::chrono::duration<double>(now - started).count() >= demoSeconds) break;
+        double sinceReport = std::chrono::duration<double>(now - lastReport).count();
+        if (sinceReport >= reportSec) { server.report(sinceReport); lastReport = now; }
+    }
+    server.report(std::max(1e-3, std::chrono::duration<double>(Clock::now() - lastReport).count()));
+
+    clientsStop = true;
+    for (auto& c : clients) c.join();
+    server.stop();
+
+    if (demoClients) {
+        uint64_t packets = 0, bytes = 0;
+        int extinguished = 0, errors = 0;
+        for (auto& r : results) {
+            packets += r.packets; bytes += r.bytes;
+            extinguished += r.extinguished ? 1 : 0;
+            errors += r.protocolError ? 1 : 0;
+        }
+        printf("\ndemo: %d clients, %llu deltas (%.1f bytes avg), %d fires out, %d protocol errors\n",
+            demoClients, (unsigned long long)packets, packets ? (double)bytes / packets : 0.0,
+            extinguished, errors);
+        return errors ? 1 : 0;
+    }
+    return 0;
+}
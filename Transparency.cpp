@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////
+// Transparency.cpp
+//
+// Depth radix sort and fill budget for the transparency pass.
+//
+////////////////////////////////////////////////////////////////
+
+#include "Transparency.h"
+
+#include <cstring>
+
+// Map float bits to an unsigned key with the same ordering, then invert
+// so ascending key order means descending depth (back-to-front).
+static uint32_t depthKey(float depth)
+{
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return ~bits;
+}
+
+void sortBackToFront(std::vector<TranslucentPrim>& prims, std::vector<TranslucentPrim>& scratch)
+{
+    const size_t n = prims.size();
+    if (n < 2) return;
+    scratch.resize(n);
+
+    // one histogram pass for all four 8-bit digits
+    uint32_t counts[4][256] = {};
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t k = depthKey(prims[i].depth);
+        counts[0][k & 0xFF]++;
+        counts[1][(k >> 8) & 0xFF]++;
+        counts[2][(k >> 16) & 0xFF]++;
+        counts[3][k >> 24]++;
+    }
+
+    TranslucentPrim* src = prims.data();
+    TranslucentPrim* dst = scratch.data();
+    for (int pass = 0; pass < 4; ++pass) {
+        uint32_t* c = counts[pass];
+        const int shift = pass * 8;
+        // all keys share this digit: nothing to reorder
+        if (c[(depthKey(src[0].depth) >> shift) & 0xFF] == n) continue;
+
+        uint32_t offset = 0;
+        for (int d = 0; d < 256; ++d) {
+            uint32_t cnt = c[d];
+            c[d] = offset;
+            offset += cnt;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t d = (depthKey(src[i].depth) >> shift) & 0xFF;
+            dst[c[d]++] = src[i];
+        }
+        TranslucentPrim* t = src; src = dst; dst = t;
+    }
+    if (src != prims.data()) prims.swap(scratch);
+}
+
+size_t fillBudgetStart(const std::vector<TranslucentPrim>& prims, float budgetPixels)
+{
+    float total = 0.0f;
+    size_t i = prims.size();
+    while (i > 0) {
+        total += prims[i - 1].coverage;
+        if (total > budgetPixels && i < prims.size()) break; // always keep the nearest
+        --i;
+    }
+    return i;
+}
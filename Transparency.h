@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////
+// Transparency.h
+//
+// CPU side of the transparency pass (no OpenGL): translucent
+// primitives are radix sorted back-to-front by view depth each
+// frame, and an optional fill budget drops the farthest ones so
+// the average blended overdraw (total coverage / viewport) stays
+// bounded on software rasterizers. Single pixels can still exceed it.
+//
+////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+static const uint32_t PRIM_SPRAY_SLICE = 0x80000000u; // spray cone slice, low bits = slice number
+
+struct TranslucentPrim
+{
+    float depth;        // distance along the view direction
+    float coverage;     // estimated screen area in pixels
+    uint32_t index;     // particle index or PRIM_SPRAY_SLICE | slice
+};
+
+// Per-frame statistics for the transparency pass.
+struct OverdrawStats
+{
+    uint32_t submitted = 0;     // translucent primitives collected
+    uint32_t drawn = 0;         // left after the fill budget
+    float estimatedPixels = 0;  // sum of coverage of drawn primitives
+    uint64_t samples = 0;       // measured blended fragments (GL query, one frame late)
+    uint32_t viewportPixels = 1;
+
+    float overdraw() const { return (float)samples / (float)viewportPixels; }
+};
+
+// Stable LSD radix sort on the float depth, farthest first.
+// scratch is reused between frames to avoid allocation.
+void sortBackToFront(std::vector<TranslucentPrim>& prims, std::vector<TranslucentPrim>& scratch);
+
+// prims must be sorted back-to-front. Returns the first index to draw so
+// that the nearest primitives' summed coverage stays within budgetPixels,
+// i.e. an average-overdraw budget of budgetPixels / viewport pixels.
+size_t fillBudgetStart(const std::vector<TranslucentPrim>& prims, float budgetPixels);
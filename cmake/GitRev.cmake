@@ -0,0 +1,25 @@
+# Writes OUTPUT (a header defining FIREQUEST_GIT_REV) from
+# `git describe --always --dirty` in SOURCE_DIR. Run as a script on every
+# build; the file is only rewritten when the revision changes, so an
+# unchanged tree does not trigger recompiles.
+#   cmake -DSOURCE_DIR=... -DOUTPUT=... -P GitRev.cmake
+
+execute_process(
+  COMMAND git describe --always --dirty
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE rev
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET)
+if(NOT rev)
+  set(rev unknown)
+endif()
+
+set(content "#define FIREQUEST_GIT_REV \"${rev}\"\n")
+if(EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} old)
+else()
+  set(old "")
+endif()
+if(NOT old STREQUAL content)
+  file(WRITE ${OUTPUT} "${content}")
+endif()
@@ -7,18 +7,26 @@
 ////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <cstdio>
 #include <string>
 #include <vector>
 #include <cmath>
 #include <array>
 
+#include "Geometry.h"
+#include "Simulation.h"
+#include "Particles.h"
+#include "Transparency.h"
+
 #include <GL/glew.h>
 #include <GL/freeglut.h>
 #include <GL/glu.h>
 
+#ifdef _MSC_VER
 #pragma comment(lib, "glew32.lib")
 #pragma comment(lib, "freeglut.lib")
 #pragma comment(lib, "opengl32.lib")
+#endif
 
 // --- Variabel Global ---
 int winW = 1024;
@@ -26,25 +34,15 @@ int winH = 768;
 int lastMouseX = winW / 2;
 int lastMouseY = winH / 2;
 
-float camX = 0.0f;
-float camY = 5.0f;
-float camZ = 20.0f;
-float camYaw = 0.0f;
-float camPitch = 0.0f;
-float moveSpeed = 0.5f;
-
-float lookX = 0.0f;
-float lookY = 0.0f;
-float lookZ = -1.0f;
-
-bool pinPulled = false;
-bool isSpraying = false;
-
-bool fireActive = true;
-float fireHealth = 100.0f;
-float fireX = 0.0f, fireY = 2.5f, fireZ = -5.0f;
+SimState sim;
+ParticleSystem particles;
 
-std::string uiMessage;
+// transparency pass
+std::vector<TranslucentPrim> translucent;
+std::vector<TranslucentPrim> translucentScratch;
+OverdrawStats overdraw;
+float fillBudget = 6.0f;    // max average overdraw: estimated coverage / viewport pixels
+bool showOverdraw = false;
 
 // Prototipe fungsi
 void setup(void);
@@ -57,7 +55,8 @@ void update(int value);
 void drawText(float x, float y, const char* text);
 void drawRoom(void);
 void drawFire(void);
-void drawSpray(void);
+void drawSpraySlice(int slice);
+void drawTransparency(void);
 void drawApar(void);
 void drawUI(void);
 void updateLogic(void);
@@ -65,7 +64,9 @@ void resetSim(void);
 
 // helpers
 static const float PI = 3.14159265358979323846f;
-static float toRadians(float degrees) { return degrees * PI / 180.0f; }
+
+static GLuint gOverdrawQuery[2] = { 0, 0 };
+static unsigned int gQueryFrame = 0;
 
 static GLUquadric* gQuad = nullptr;
 static void ensureQuadric()
@@ -153,17 +154,16 @@ void setup(void)
 
     ensureQuadric();
 
+    // GL 1.5 occlusion queries count the fragments blended by the transparency pass
+    if (GLEW_VERSION_1_5) glGenQueries(2, gOverdrawQuery);
+
     resetSim();
 }
 
 void resetSim(void)
 {
-    pinPulled = false;
-    isSpraying = false;
-    fireActive = true;
-    fireHealth = 100.0f;
-    camX = 0.0f; camY = 5.0f; camZ = 20.0f;
-    camYaw = 0.0f; camPitch = 0.0f;
+    simReset(sim);
+    particlesReset(particles);
     glutWarpPointer(winW / 2, winH / 2);
     lastMouseX = winW / 2; lastMouseY = winH / 2;
 }
@@ -201,51 +201,19 @@ static void drawHoseBezierTube(float p0x, float p0y, float p0z,
     ensureQuadric();
     // sample points and draw small cylinders oriented between samples
     std::vector<std::array<float, 3>> pts;
-    pts.reserve(segments);
-    for (int i = 0; i < segments; ++i) {
-        float t = (float)i / (segments - 1);
-        float omt = 1.0f - t;
-        float x = omt * omt * p0x + 2 * omt * t * p1x + t * t * p2x;
-        float y = omt * omt * p0y + 2 * omt * t * p1y + t * t * p2y;
-        float z = omt * omt * p0z + 2 * omt * t * p1z + t * t * p2z;
-        pts.push_back({ x,y,z });
-    }
+    std::vector<HoseSegment> segs;
+    sampleQuadraticBezier(p0x, p0y, p0z, p1x, p1y, p1z, p2x, p2y, p2z, segments, pts);
+    buildHoseSegments(pts, segs);
 
     // draw small cylinders between consecutive pts
-    for (int i = 0; i < (int)pts.size() - 1; ++i) {
-        auto a = pts[i];
-        auto b = pts[i + 1];
-        float vx = b[0] - a[0], vy = b[1] - a[1], vz = b[2] - a[2];
-        float len = sqrtf(vx * vx + vy * vy + vz * vz);
-        if (len <= 1e-5f) continue;
-
-        // compute rotation to align +Z to vector (vx,vy,vz)
-        float ax = 0.0f, ay = 0.0f, az = 1.0f; // source axis (glu cylinder points +Z originally)
-        // rotation axis = cross(ax, v)
-        float rx = ay * vz - az * vy;
-        float ry = az * vx - ax * vz;
-        float rz = ax * vy - ay * vx;
-        float rlen = sqrtf(rx * rx + ry * ry + rz * rz);
-        float dot = ax * vx + ay * vy + az * vz;
-        float angle = 0.0f;
-        if (rlen > 1e-5f) {
-            angle = acosf(dot / (len)) * 180.0f / PI;
-            // normalize axis
-            rx /= rlen; ry /= rlen; rz /= rlen;
-        }
-        else {
-            // parallel or anti-parallel
-            rx = 1.0f; ry = 0.0f; rz = 0.0f;
-            angle = (dot >= 0.0f) ? 0.0f : 180.0f;
-        }
-
+    for (const HoseSegment& seg : segs) {
         glPushMatrix();
-        glTranslatef(a[0], a[1], a[2]);
-        glRotatef(angle, rx, ry, rz);
+        glTranslatef(seg.x, seg.y, seg.z);
+        glRotatef(seg.angle, seg.rx, seg.ry, seg.rz);
         // draw cylinder along +Z
         glRotatef(-90.0f, 1, 0, 0); // now gluCylinder points +Y, rotate so it points +Z
         setDiffuseColor(0.06f, 0.06f, 0.06f);
-        gluCylinder(gQuad, tubeRadius, tubeRadius, len, 12, 2);
+        gluCylinder(gQuad, tubeRadius, tubeRadius, seg.len, 12, 2);
         glPopMatrix();
     }
 
@@ -371,7 +339,7 @@ void drawApar(void)
     glPushMatrix();
     // pivot point in front of valve block
     glTranslatef(0.0f, bodyHeight + 0.12f, 0.10f);
-    if (isSpraying) glRotatef(-18.0f, 1, 0, 0); // slight squeeze animation
+    if (sim.isSpraying) glRotatef(-18.0f, 1, 0, 0); // slight squeeze animation
 
     // lever back plate (thin)
     glPushMatrix();
@@ -400,7 +368,7 @@ void drawApar(void)
     glPopMatrix();
 
     // --- Safety pin & ring (yellow) moved to SIDE (+X) for better visibility ---
-    if (!pinPulled) {
+    if (!sim.pinPulled) {
         glPushMatrix();
         // pin rod (silver) - now on positive X side so camera sees it clearly
         setDiffuseColor(0.78f, 0.78f, 0.78f);
@@ -495,14 +463,14 @@ void drawScene(void)
     glLoadIdentity();
 
     // camera
-    gluLookAt(camX, camY, camZ,
-        camX + lookX, camY + lookY, camZ + lookZ,
+    gluLookAt(sim.camX, sim.camY, sim.camZ,
+        sim.camX + sim.lookX, sim.camY + sim.lookY, sim.camZ + sim.lookZ,
         0.0f, 1.0f, 0.0f);
 
     // world objects
     drawRoom();
     drawFire();
-    if (isSpraying) drawSpray();
+    drawTransparency(); // translucent spray, flames and smoke, after all opaque geometry
 
     // View-model APAR (draw on top)
     glClear(GL_DEPTH_BUFFER_BIT);
@@ -544,41 +512,200 @@ void drawRoom(void)
 
 void drawFire(void)
 {
-    if (!fireActive) return;
+    if (!sim.fireActive) return;
     float flicker = 1.0f + (rand() % 100) / 500.0f;
     glPushMatrix();
-    glTranslatef(fireX, fireY, fireZ);
+    glTranslatef(sim.fireX, sim.fireY, sim.fireZ);
     setDiffuseColor(1.0f, 0.6f, 0.08f);
     glScalef(1.6f * flicker, 6.0f * flicker, 1.6f * flicker);
     glutSolidCone(1.0, 1.0, 16, 4);
     glPopMatrix();
     glPushMatrix();
-    glTranslatef(fireX, fireY, fireZ);
+    glTranslatef(sim.fireX, sim.fireY, sim.fireZ);
     setDiffuseColor(1.0f, 1.0f, 0.0f);
     glScalef(1.2f * flicker, 4.0f * flicker, 1.2f * flicker);
     glutSolidCone(1.0, 1.0, 16, 4);
     glPopMatrix();
 }
 
-void drawSpray(void)
+// Spray cone: 1.5 units ahead, wide end at the nozzle, narrowing to the tip.
+// Split along its axis so each slice is depth sorted on its own.
+static const int SPRAY_SLICES = 4;
+static const float SPRAY_LENGTH = 16.0f;
+static const float SPRAY_RADIUS = 0.6f * 4.2f;
+
+static void sprayConeFrame(float origin[3], float axis[3])
 {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    origin[0] = sim.camX + sim.lookX * 1.5f;
+    origin[1] = sim.camY + sim.lookY * 1.5f - 0.5f;
+    origin[2] = sim.camZ + sim.lookZ * 1.5f;
+    // +Z after glRotatef(camYaw, 0,1,0) * glRotatef(camPitch, 1,0,0)
+    float yaw = sim.camYaw * PI / 180.0f, pitch = sim.camPitch * PI / 180.0f;
+    axis[0] = sinf(yaw) * cosf(pitch);
+    axis[1] = -sinf(pitch);
+    axis[2] = cosf(yaw) * cosf(pitch);
+}
+
+// One slice of the spray cone; blend/depth/cull state is set up by drawTransparency().
+void drawSpraySlice(int slice)
+{
+    float z0 = SPRAY_LENGTH * slice / SPRAY_SLICES;
+    float z1 = SPRAY_LENGTH * (slice + 1) / SPRAY_SLICES;
+    float r0 = SPRAY_RADIUS * (1.0f - z0 / SPRAY_LENGTH);
+    float r1 = SPRAY_RADIUS * (1.0f - z1 / SPRAY_LENGTH);
 
-    glPushAttrib(GL_CURRENT_BIT | GL_ENABLE_BIT);
-    glDisable(GL_LIGHTING); // keep spray bright
     glColor4f(1.0f, 1.0f, 1.0f, 0.28f);
     glPushMatrix();
-    glTranslatef(camX + lookX * 1.5f, camY + lookY * 1.5f - 0.5f, camZ + lookZ * 1.5f);
-    glRotatef(camYaw, 0, 1, 0);
-    glRotatef(camPitch, 1, 0, 0);
-    glScalef(4.2f, 4.2f, 16.0f);
-    glutSolidCone(0.6, 1.0, 12, 4);
+    glTranslatef(sim.camX + sim.lookX * 1.5f, sim.camY + sim.lookY * 1.5f - 0.5f, sim.camZ + sim.lookZ * 1.5f);
+    glRotatef(sim.camYaw, 0, 1, 0);
+    glRotatef(sim.camPitch, 1, 0, 0);
+    if (slice == 0) {
+        // base cap faces -Z like glutSolidCone's
+        gluQuadricOrientation(gQuad, GLU_INSIDE);
+        gluDisk(gQuad, 0.0, r0, 12, 1);
+        gluQuadricOrientation(gQuad, GLU_OUTSIDE);
+    }
+    glTranslatef(0.0f, 0.0f, z0);
+    gluCylinder(gQuad, r0, r1, z1 - z0, 12, 1);
     glPopMatrix();
-    glEnable(GL_LIGHTING);
-    glPopAttrib();
+}
 
-    glDisable(GL_BLEND);
+// Soft camera-facing hexagon: opaque-ish center fading to the rim.
+static void emitParticle(const Particle& p, const float right[3], const float up[3])
+{
+    float t = p.t();
+    float r, g, b, a;
+    switch (p.kind)
+    {
+    case PARTICLE_FLAME: r = 1.0f; g = 0.9f - 0.6f * t; b = 0.2f - 0.2f * t; a = 0.55f * (1.0f - t); break;
+    case PARTICLE_SMOKE: r = g = b = 0.35f + 0.2f * t; a = 0.22f * (1.0f - t) * fminf(1.0f, p.age * 4.0f); break;
+    default: r = 0.95f; g = 0.97f; b = 1.0f; a = 0.35f * (1.0f - t); break;
+    }
+    float size = p.size();
+    float prevX = 0.0f, prevY = 0.0f, prevZ = 0.0f;
+    for (int i = 0; i <= 6; ++i) {
+        float ang = i * (PI / 3.0f);
+        float cu = cosf(ang) * size, su = sinf(ang) * size;
+        float x = p.x + right[0] * cu + up[0] * su;
+        float y = p.y + right[1] * cu + up[1] * su;
+        float z = p.z + right[2] * cu + up[2] * su;
+        if (i > 0) {
+            glColor4f(r, g, b, a); glVertex3f(p.x, p.y, p.z);
+            glColor4f(r, g, b, 0.0f); glVertex3f(prevX, prevY, prevZ);
+            glVertex3f(x, y, z);
+        }
+        prevX = x; prevY = y; prevZ = z;
+    }
+}
+
+// Transparency stage: collect translucent primitives, sort back-to-front by
+// view depth, trim to the fill budget and draw with depth writes off.
+void drawTransparency(void)
+{
+    const float viewportPixels = (float)winW * (float)winH;
+    const float pxPerUnit = (winH * 0.5f) / tanf(45.0f * 0.5f * PI / 180.0f);
+
+    // billboard basis from the look vector (also used for frustum culling)
+    float right[3] = { -sim.lookZ, 0.0f, sim.lookX };
+    float rlen = sqrtf(right[0] * right[0] + right[2] * right[2]);
+    if (rlen > 1e-6f) { right[0] /= rlen; right[2] /= rlen; }
+    else { right[0] = 1.0f; right[2] = 0.0f; }
+    float up[3] = {
+        right[1] * sim.lookZ - right[2] * sim.lookY,
+        right[2] * sim.lookX - right[0] * sim.lookZ,
+        right[0] * sim.lookY - right[1] * sim.lookX };
+
+    translucent.clear();
+    for (size_t i = 0; i < particles.particles.size(); ++i) {
+        const Particle& p = particles.particles[i];
+        float dx = p.x - sim.camX, dy = p.y - sim.camY, dz = p.z - sim.camZ;
+        float depth = dx * sim.lookX + dy * sim.lookY + dz * sim.lookZ;
+        if (depth < 0.1f) continue; // behind the near plane
+        float rpx = p.size() * pxPerUnit / depth;
+        // off-screen sideways or vertically: never drawn, so keep it out of the fill budget
+        float sx = (dx * right[0] + dy * right[1] + dz * right[2]) * pxPerUnit / depth;
+        float sy = (dx * up[0] + dy * up[1] + dz * up[2]) * pxPerUnit / depth;
+        if (fabsf(sx) - rpx > winW * 0.5f || fabsf(sy) - rpx > winH * 0.5f) continue;
+        translucent.push_back({ depth, fminf(PI * rpx * rpx, viewportPixels), (uint32_t)i });
+    }
+    if (sim.isSpraying) {
+        float origin[3], axis[3];
+        sprayConeFrame(origin, axis);
+        float cosA = fabsf(axis[0] * sim.lookX + axis[1] * sim.lookY + axis[2] * sim.lookZ);
+        float sinA = sqrtf(fmaxf(0.0f, 1.0f - cosA * cosA));
+        for (int k = 0; k < SPRAY_SLICES; ++k) {
+            float z0 = SPRAY_LENGTH * k / SPRAY_SLICES, z1 = SPRAY_LENGTH * (k + 1) / SPRAY_SLICES;
+            float zm = 0.5f * (z0 + z1);
+            float rm = SPRAY_RADIUS * (1.0f - zm / SPRAY_LENGTH);
+            float dx = origin[0] + axis[0] * zm - sim.camX;
+            float dy = origin[1] + axis[1] * zm - sim.camY;
+            float dz = origin[2] + axis[2] * zm - sim.camZ;
+            float depth = dx * sim.lookX + dy * sim.lookY + dz * sim.lookZ; // slice centroid
+            // projected silhouette: side band plus the end-on disc
+            float sc = pxPerUnit / fmaxf(depth, 0.1f);
+            float wpx = 2.0f * rm * sc;
+            float coverage = wpx * (z1 - z0) * sinA * sc + PI * rm * rm * sc * sc * cosA;
+            if (depth > 0.1f) {
+                float sx = (dx * right[0] + dy * right[1] + dz * right[2]) * sc;
+                float sy = (dx * up[0] + dy * up[1] + dz * up[2]) * sc;
+                float ext = 0.5f * (z1 - z0) * sc + wpx * 0.5f;
+                if (fabsf(sx) - ext > winW * 0.5f || fabsf(sy) - ext > winH * 0.5f) continue;
+            }
+            translucent.push_back({ depth, fminf(coverage, viewportPixels), PRIM_SPRAY_SLICE | (uint32_t)k });
+        }
+    }
+
+    sortBackToFront(translucent, translucentScratch);
+    size_t first = fillBudgetStart(translucent, fillBudget * viewportPixels);
+
+    overdraw.submitted = (uint32_t)translucent.size();
+    overdraw.drawn = (uint32_t)(translucent.size() - first);
+    overdraw.estimatedPixels = 0.0f;
+    overdraw.viewportPixels = (uint32_t)viewportPixels;
+
+    glPushAttrib(GL_CURRENT_BIT | GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE); // test against opaque depth, never write
+    glDisable(GL_LIGHTING); // keep spray and flames bright
+
+    bool query = gOverdrawQuery[0] != 0;
+    if (query) glBeginQuery(GL_SAMPLES_PASSED, gOverdrawQuery[gQueryFrame & 1]);
+
+    bool inBatch = false;
+    for (size_t i = first; i < translucent.size(); ++i) {
+        const TranslucentPrim& prim = translucent[i];
+        overdraw.estimatedPixels += prim.coverage;
+        if (prim.index & PRIM_SPRAY_SLICE) {
+            if (inBatch) { glEnd(); inBatch = false; }
+            // cull the far inner wall so it cannot wash over nearer particles
+            glEnable(GL_CULL_FACE);
+            drawSpraySlice((int)(prim.index & ~PRIM_SPRAY_SLICE));
+            glDisable(GL_CULL_FACE);
+            continue;
+        }
+        if (!inBatch) { glBegin(GL_TRIANGLES); inBatch = true; }
+        emitParticle(particles.particles[prim.index], right, up);
+    }
+    if (inBatch) glEnd();
+
+    if (query) {
+        glEndQuery(GL_SAMPLES_PASSED);
+        // read last frame's result so the pass never stalls on the GPU
+        if (gQueryFrame > 0) {
+            GLuint prev = gOverdrawQuery[(gQueryFrame + 1) & 1];
+            GLint available = 0;
+            glGetQueryObjectiv(prev, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint samples = 0;
+                glGetQueryObjectuiv(prev, GL_QUERY_RESULT, &samples);
+                overdraw.samples = samples;
+            }
+        }
+        gQueryFrame++;
+    }
+
+    glPopAttrib();
 }
 
 void drawUI(void)
@@ -592,14 +719,24 @@ void drawUI(void)
     glLoadIdentity();
     glDisable(GL_DEPTH_TEST);
 
-    if (fireActive) setDiffuseColor(1.0f, 1.0f, 1.0f);
+    if (sim.fireActive) setDiffuseColor(1.0f, 1.0f, 1.0f);
     else setDiffuseColor(0.0f, 1.0f, 0.0f);
-    drawText(10.0f, 50.0f, uiMessage.c_str());
+    drawText(10.0f, 50.0f, simMessageText(sim.message));
 
     setDiffuseColor(0.0f, 0.0f, 0.0f);
-    drawText(10.0f, 30.0f, "Tekan 'R' untuk Reset, 'ESC' untuk Keluar");
+    drawText(10.0f, 30.0f, "Tekan 'R' untuk Reset, 'O' untuk Statistik Overdraw, 'ESC' untuk Keluar");
     drawText(winW / 2 - 5, winH / 2 - 5, "+");
 
+    if (showOverdraw) {
+        char buf[160];
+        snprintf(buf, sizeof(buf), "Transparan: %u/%u prim, partikel %zu/%zu ('[' ']')",
+            overdraw.drawn, overdraw.submitted, particles.particles.size(), particles.maxParticles);
+        drawText(10.0f, winH - 20.0f, buf);
+        snprintf(buf, sizeof(buf), "Overdraw: %.2fx terukur, %.2fx estimasi (batas rata-rata %.1fx)",
+            overdraw.overdraw(), overdraw.estimatedPixels / overdraw.viewportPixels, fillBudget);
+        drawText(10.0f, winH - 38.0f, buf);
+    }
+
     glEnable(GL_DEPTH_TEST);
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
@@ -619,42 +756,14 @@ void drawText(float x, float y, const char* text)
 void update(int value)
 {
     updateLogic();
+    particlesUpdate(particles, sim, 0.016f);
     glutPostRedisplay();
     glutTimerFunc(16, update, 0);
 }
 
 void updateLogic(void)
 {
-    // look vector from yaw/pitch
-    lookX = cosf(toRadians(camYaw)) * cosf(toRadians(camPitch));
-    lookY = sinf(toRadians(camPitch));
-    lookZ = sinf(toRadians(camYaw)) * cosf(toRadians(camPitch));
-    float len = sqrtf(lookX * lookX + lookY * lookY + lookZ * lookZ);
-    if (len > 1e-6f) { lookX /= len; lookY /= len; lookZ /= len; }
-
-    if (!fireActive) {
-        uiMessage = "Api Berhasil Dipadamkan! Tekan 'R' untuk Reset.";
-        isSpraying = false;
-    }
-    else if (!pinPulled) {
-        uiMessage = "APAR Terkunci. Tekan 'E' untuk Tarik Pin.";
-    }
-    else if (!isSpraying) {
-        uiMessage = "APAR Siap. Tahan Klik Kiri untuk Semprot (SQUEEZE).";
-    }
-    else {
-        uiMessage = "Menyemprot! Arahkan ke DASAR Api (AIM & SWEEP)!";
-    }
-
-    if (isSpraying && fireActive) {
-        float vx = fireX - camX, vy = fireY - camY, vz = fireZ - camZ;
-        float dist = sqrtf(vx * vx + vy * vy + vz * vz);
-        if (dist > 1e-6f) { vx /= dist; vy /= dist; vz /= dist; }
-        float dot = lookX * vx + lookY * vy + lookZ * vz;
-        if (dot > 0.95f && dist < 25.0f) fireHealth -= 1.5f;
-    }
-
-    if (fireHealth <= 0.0f) fireActive = false;
+    simUpdateLogic(sim);
 }
 
 void resize(int w, int h)
@@ -669,29 +778,22 @@ void resize(int w, int h)
 
 void keyInput(unsigned char key, int x, int y)
 {
-    float rightX = cosf(toRadians(camYaw - 90.0f));
-    float rightZ = sinf(toRadians(camYaw - 90.0f));
-
     switch (key)
     {
     case 27: exit(0); break;
-    case 'w': camX += lookX * moveSpeed; camZ += lookZ * moveSpeed; break;
-    case 's': camX -= lookX * moveSpeed; camZ -= lookZ * moveSpeed; break;
-    case 'a': camX += rightX * moveSpeed; camZ += rightZ * moveSpeed; break;
-    case 'd': camX -= rightX * moveSpeed; camZ -= rightZ * moveSpeed; break;
-    case 'e': if (!pinPulled) pinPulled = true; break;
     case 'r': resetSim(); break;
+    case 'o':
+    case 'O': showOverdraw = !showOverdraw; break;
+    case '[': if (particles.maxParticles > 64) particles.maxParticles /= 2; break;
+    case ']': if (particles.maxParticles < 65536) particles.maxParticles *= 2; break;
+    default: simKeyInput(sim, key); break;
     }
 }
 
 void mouseClick(int button, int state, int x, int y)
 {
-    if (button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
-        if (pinPulled && fireActive) isSpraying = true;
-    }
-    else if (button == GLUT_LEFT_BUTTON && state == GLUT_UP) {
-        isSpraying = false;
-    }
+    if (button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) simMouseButton(sim, true);
+    else if (button == GLUT_LEFT_BUTTON && state == GLUT_UP) simMouseButton(sim, false);
 }
 
 void passiveMotion(int x, int y)
@@ -699,14 +801,10 @@ void passiveMotion(int x, int y)
     float deltaX = (float)(x - lastMouseX);
     float deltaY = (float)(y - lastMouseY);
     lastMouseX = x; lastMouseY = y;
-    float sensitivity = 0.15f;
-    camYaw += deltaX * sensitivity;
-    camPitch -= deltaY * sensitivity;
-    if (camPitch > 89.0f) camPitch = 89.0f;
-    if (camPitch < -89.0f) camPitch = -89.0f;
+    simMouseLook(sim, deltaX, deltaY);
 
     if (x != winW / 2 || y != winH / 2) {
         glutWarpPointer(winW / 2, winH / 2);
         lastMouseX = winW / 2; lastMouseY = winH / 2;
     }
-}
\ No newline at end of file
+}